@@ -3,6 +3,26 @@
 #include <cstdlib>
 #include <cmath>
 #include <cctype>
+#include <string>
+#include <future>
+#include <chrono>
+#include <limits>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 using namespace std;
 
@@ -48,16 +68,62 @@ class Board{
             WinStreak = 0;
         }
 
-        //Prints out the current state of the board
-        void PrintBoard(){
-            cout << "   1   2   3   4   5   6   7  \n";
+        /*Copies every space of another board, so the copy can be read while
+        the original keeps changing*/
+        Board(const Board &Other){
+            BoardArray = new char *[6];
+            for (int i = 0; i < 6; i++){
+                BoardArray[i] = new char[7];
+                for (int j = 0; j < 7; j++){
+                    BoardArray[i][j] = Other.BoardArray[i][j];
+                }
+            }
+            GameWon = Other.GameWon;
+            LastWinner = Other.LastWinner;
+            WinStreak = Other.WinStreak;
+        }
+
+        //Copies every space of another board into this one
+        Board &operator=(const Board &Other){
+            for (int i = 0; i < 6; i++){
+                for (int j = 0; j < 7; j++){
+                    BoardArray[i][j] = Other.BoardArray[i][j];
+                }
+            }
+            GameWon = Other.GameWon;
+            LastWinner = Other.LastWinner;
+            WinStreak = Other.WinStreak;
+            return *this;
+        }
+
+        //Frees up the memory used by the board
+        ~Board(){
+            for (int i = 0; i < 6; i++){
+                delete[] BoardArray[i];
+            }
+            delete[] BoardArray;
+        }
+
+        /*Builds the current state of the board into one string so it can be
+        written out all at once instead of a piece at a time*/
+        string RenderBoard(){
+            string Frame;
+            Frame.reserve(32 + 6 * 32);
+            Frame += "   1   2   3   4   5   6   7  \n";
             for(int i = 0; i < 6; i++){
-                cout << " | ";
+                Frame += " | ";
                 for (int j = 0; j < 7; j++){
-                    cout << BoardArray[i][j] << " | ";
+                    Frame += BoardArray[i][j];
+                    Frame += " | ";
                 }
-                cout << '\n';
+                Frame += '\n';
             }
+            return Frame;
+        }
+
+        //Prints out the current state of the board
+        void PrintBoard(){
+            cout << RenderBoard();
         }
 
          /*A helper function to check horizontal directions genercially.
@@ -244,6 +310,9 @@ class Player{
         bool GetCPU(){
             return IsCPU;
         }
+
+        //Virtual so computer players get cleaned up properly through a Player pointer
+        virtual ~Player(){}
 };
 
 //A free space on the board
@@ -267,11 +336,852 @@ struct Space {
     int LeastBlock; //Lowest number of opponent's pieces this space can block
 };
 
+/*A compact copy of the board used for fast simulations. Each column takes 7 bits,
+6 for its rows from the bottom up and 1 left empty on top so pieces in different
+columns never look connected*/
+class BitBoard{
+    private:
+
+        //Bit for the bottom row of the given column
+        static uint64_t BottomMask(int Col){
+            return UINT64_C(1) << (Col * 7);
+        }
+
+        //Bit for the top row of the given column
+        static uint64_t TopMask(int Col){
+            return UINT64_C(1) << (Col * 7 + 5);
+        }
+
+        //Every playable bit in the given column
+        static uint64_t ColumnMask(int Col){
+            return ((UINT64_C(1) << 6) - 1) << (Col * 7);
+        }
+
+        //Checks if the given pieces have 4 in a row in any direction
+        static bool Aligned(uint64_t Pieces){
+            //Shifts are horizontal, up-left diagonal, up-right diagonal, and vertical
+            const int Shifts[4] = {7, 6, 8, 1};
+            for (int i = 0; i < 4; i++){
+                uint64_t Pairs = Pieces & (Pieces >> Shifts[i]);
+                if (Pairs & (Pairs >> (2 * Shifts[i]))){
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    public:
+
+        //Pieces belonging to the player whose turn it is
+        uint64_t Current;
+
+        //Every piece on the board
+        uint64_t Mask;
+
+        //Number of pieces played so far
+        int Moves;
+
+        //Sets up an empty board
+        BitBoard(){
+            Current = 0;
+            Mask = 0;
+            Moves = 0;
+        }
+
+        //Copies a regular board, with Color being the player whose turn it is
+        BitBoard(char **Board, char Color){
+            Current = 0;
+            Mask = 0;
+            Moves = 0;
+            for (int i = 0; i < 6; i++){
+                for (int j = 0; j < 7; j++){
+                    if (Board[i][j] == '-'){
+                        continue;
+                    }
+                    uint64_t Bit = UINT64_C(1) << (j * 7 + (5 - i));
+                    Mask |= Bit;
+                    if (Board[i][j] == Color){
+                        Current |= Bit;
+                    }
+                    Moves++;
+                }
+            }
+        }
+
+        //Checks if the given column has room for another piece
+        bool CanPlay(int Col){
+            return (Mask & TopMask(Col)) == 0;
+        }
+
+        //Drops a piece for the current player, then hands the turn over
+        void Play(int Col){
+            Current ^= Mask;
+            Mask |= Mask + BottomMask(Col);
+            Moves++;
+        }
+
+        //Checks if playing the given column wins for the current player
+        bool IsWinningMove(int Col){
+            return Aligned(Current | ((Mask + BottomMask(Col)) & ColumnMask(Col)));
+        }
+
+        //Checks if board is full
+        bool IsFull(){
+            return Moves == 42;
+        }
+
+        //Fills Cols with every column that isn't full and returns how many there are
+        int PlayableCols(int (&Cols)[7]){
+            int Num = 0;
+            for (int i = 0; i < 7; i++){
+                if (CanPlay(i)){
+                    Cols[Num++] = i;
+                }
+            }
+            return Num;
+        }
+
+        //Checks if both boards have the same pieces with the same player to move
+        bool operator==(const BitBoard &Other) const{
+            return Current == Other.Current && Mask == Other.Mask;
+        }
+
+        /*A number unique to this position. Adding Mask sets the bit above each
+        column's top piece, which tells apart empty spaces from the other player's*/
+        uint64_t Key(){
+            return Current + Mask;
+        }
+
+        //Returns this board flipped left to right
+        BitBoard Mirrored(){
+            BitBoard Flipped;
+            for (int i = 0; i < 7; i++){
+                int Shift = (6 - 2 * i) * 7;
+                uint64_t Col = ColumnMask(i);
+                Flipped.Current |= Shift >= 0 ? (Current & Col) << Shift : (Current & Col) >> -Shift;
+                Flipped.Mask |= Shift >= 0 ? (Mask & Col) << Shift : (Mask & Col) >> -Shift;
+            }
+            Flipped.Moves = Moves;
+            return Flipped;
+        }
+};
+
+/*A search result saved in the cache file. Always 16 bytes so records can be
+read straight out of the file*/
+struct CacheRecord {
+    uint64_t Key; //Key of the position, whichever of it and its mirror image is smaller
+    uint32_t Budget; //Playout budget of the search the result came from
+    uint16_t Score; //Win rate of BestCol for the player to move, out of 10000
+    int8_t BestCol; //Best column found, for the unmirrored side of Key
+    uint8_t Check; //Checksum of the other fields, so half written records get skipped
+};
+
+#ifndef _WIN32
+
+/*Saves search results in a file so they survive restarts and can be shared
+between processes. Results are only shared between searches with the same
+playout budget, and a few are kept per position so play doesn't become the same
+every game. The file is a header, a block of records sorted by key and budget,
+and a tail of records appended since. Every process maps the file into memory and
+looks records up right in the mapping, binary searching the sorted block and
+scanning the tail, so the records are never copied into each process. Writers
+take turns through a lock file, and once the tail gets long the file is
+rewritten sorted*/
+class ResultCache{
+    private:
+
+        //Path of the cache file
+        string Path;
+
+        //The open cache file, or -1 if there isn't one
+        int Fd;
+
+        //The open lock file that writers take turns on, or -1 if there isn't one
+        int LockFd;
+
+        //Identifies which file Fd is, so we notice when it gets replaced by compaction
+        ino_t Inode;
+
+        //The cache file mapped into memory
+        const char *Map;
+        size_t MapSize;
+
+        //Number of records in the sorted block right after the header
+        size_t SortedCount;
+
+        /*Most records kept after compacting. Each position and budget can take up
+        to SAMPLES_PER_TIER of them*/
+        size_t MaxEntries;
+
+        //Keeps threads in this process from using the cache at the same time
+        mutex CacheLock;
+
+        //Marks the start of every cache file. Followed by the sorted record count
+        static const char *Magic(){
+            return "C4CACHE3";
+        }
+
+        //Size of the file header. Records start right after it
+        static const size_t HEADER_SIZE = 16;
+
+        //Most records appended after the sorted block before the file gets compacted
+        static const size_t TAIL_LIMIT = 4096;
+
+        //Xors together every byte of the record besides the checksum
+        static uint8_t Checksum(const CacheRecord &Rec){
+            const uint8_t *Bytes = (const uint8_t *)&Rec;
+            uint8_t Sum = 0x5A;
+            for (int i = 0; i < (int)offsetof(CacheRecord, Check); i++){
+                Sum ^= Bytes[i];
+            }
+            return Sum;
+        }
+
+        //Key shared by Pos and its mirror image. Mirror is set if Pos had to be flipped
+        static uint64_t CanonicalKey(BitBoard Pos, bool &Mirror){
+            uint64_t Key = Pos.Key();
+            uint64_t MirrorKey = Pos.Mirrored().Key();
+            Mirror = MirrorKey < Key;
+            return Mirror ? MirrorKey : Key;
+        }
+
+        //Number of whole records in the mapping
+        size_t MappedRecords(){
+            return MapSize < HEADER_SIZE ? 0 : (MapSize - HEADER_SIZE) / sizeof(CacheRecord);
+        }
+
+        //Reads the record at the given position straight out of the mapping
+        CacheRecord RecordAt(size_t Index){
+            CacheRecord Rec;
+            memcpy(&Rec, Map + HEADER_SIZE + Index * sizeof(CacheRecord), sizeof(CacheRecord));
+            return Rec;
+        }
+
+        //Unmaps and closes the cache file
+        void CloseFile(){
+            if (Map != nullptr){
+                munmap((void *)Map, MapSize);
+                Map = nullptr;
+                MapSize = 0;
+            }
+            if (Fd != -1){
+                close(Fd);
+                Fd = -1;
+            }
+        }
+
+        /*Opens the file at Path, writing a header if it's empty. Returns false if
+        it can't be opened or isn't a cache file*/
+        bool OpenFile(){
+            CloseFile();
+            Fd = open(Path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+            if (Fd == -1){
+                return false;
+            }
+            struct stat FileStat;
+            if (fstat(Fd, &FileStat) == -1){
+                CloseFile();
+                return false;
+            }
+            char Header[HEADER_SIZE] = {0};
+            if (FileStat.st_size == 0){
+                memcpy(Header, Magic(), 8);
+                if (write(Fd, Header, HEADER_SIZE) != (ssize_t)HEADER_SIZE){
+                    CloseFile();
+                    return false;
+                }
+            } else if (pread(Fd, Header, HEADER_SIZE, 0) != (ssize_t)HEADER_SIZE || memcmp(Header, Magic(), 8) != 0){
+                CloseFile();
+                return false;
+            }
+            uint64_t Sorted = 0;
+            memcpy(&Sorted, Header + 8, sizeof(Sorted));
+            if (FileStat.st_size > 0 && HEADER_SIZE + Sorted * sizeof(CacheRecord) > (uint64_t)FileStat.st_size){
+                CloseFile();
+                return false;
+            }
+            SortedCount = Sorted;
+            Inode = FileStat.st_ino;
+            return true;
+        }
+
+        /*Catches up with whatever other processes have written. Reopens the file
+        if it was replaced by compaction, then maps any new records*/
+        void Refresh(){
+            struct stat PathStat;
+            if (stat(Path.c_str(), &PathStat) == 0 && PathStat.st_ino != Inode && !OpenFile()){
+                return;
+            }
+            struct stat FileStat;
+            if (Fd == -1 || fstat(Fd, &FileStat) == -1){
+                return;
+            }
+            size_t Size = FileStat.st_size;
+            if (Size > MapSize){
+                if (Map != nullptr){
+                    munmap((void *)Map, MapSize);
+                }
+                void *NewMap = mmap(nullptr, Size, PROT_READ, MAP_SHARED, Fd, 0);
+                if (NewMap == MAP_FAILED){
+                    Map = nullptr;
+                    MapSize = 0;
+                    return;
+                }
+                Map = (const char *)NewMap;
+                MapSize = Size;
+            }
+        }
+
+        /*Collects every record for Key from a search with the given budget, looking
+        in both the sorted block and the tail*/
+        void FindSamples(uint64_t Key, uint32_t Budget, vector<CacheRecord> &Samples){
+            Samples.clear();
+            size_t Total = MappedRecords();
+            size_t Sorted = min(SortedCount, Total);
+            size_t Low = 0;
+            size_t High = Sorted;
+            while (Low < High){
+                size_t Mid = Low + (High - Low) / 2;
+                CacheRecord Rec = RecordAt(Mid);
+                if (Rec.Key < Key || (Rec.Key == Key && Rec.Budget < Budget)){
+                    Low = Mid + 1;
+                } else {
+                    High = Mid;
+                }
+            }
+            for (size_t i = Low; i < Total; i++){
+                CacheRecord Rec = RecordAt(i);
+                bool Matches = Rec.Key == Key && Rec.Budget == Budget;
+                if (i < Sorted && !Matches){
+                    //Past the matches in the sorted block, so skip ahead to the tail
+                    i = Sorted - 1;
+                    continue;
+                }
+                if (Matches && Rec.Check == Checksum(Rec)){
+                    Samples.push_back(Rec);
+                }
+            }
+        }
+
+        /*Rewrites the file sorted by key and budget with at most SAMPLES_PER_TIER
+        records each, keeping the MaxEntries from the biggest budgets. Must hold
+        the lock file*/
+        void Compact(){
+            vector<CacheRecord> Records;
+            size_t Total = MappedRecords();
+            Records.reserve(Total);
+            for (size_t i = 0; i < Total; i++){
+                CacheRecord Rec = RecordAt(i);
+                if (Rec.Check == Checksum(Rec)){
+                    Records.push_back(Rec);
+                }
+            }
+
+            stable_sort(Records.begin(), Records.end(), [](const CacheRecord &a, const CacheRecord &b){
+                return a.Key != b.Key ? a.Key < b.Key : a.Budget < b.Budget;
+            });
+            size_t Kept = 0;
+            for (size_t i = 0; i < Records.size(); i++){
+                if (Kept >= SAMPLES_PER_TIER && Records.at(Kept - SAMPLES_PER_TIER).Key == Records.at(i).Key &&
+                        Records.at(Kept - SAMPLES_PER_TIER).Budget == Records.at(i).Budget){
+                    continue;
+                }
+                Records.at(Kept++) = Records.at(i);
+            }
+            Records.resize(Kept);
+
+            //Bigger budgets cost more to redo, so they're the ones worth keeping
+            if (Records.size() > MaxEntries){
+                nth_element(Records.begin(), Records.begin() + MaxEntries, Records.end(),
+                    [](const CacheRecord &a, const CacheRecord &b){ return a.Budget > b.Budget; });
+                Records.resize(MaxEntries);
+                sort(Records.begin(), Records.end(), [](const CacheRecord &a, const CacheRecord &b){
+                    return a.Key != b.Key ? a.Key < b.Key : a.Budget < b.Budget;
+                });
+            }
+
+            //Written to the side first so readers never see a half finished file
+            string TempPath = Path + ".tmp";
+            int TempFd = open(TempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (TempFd == -1){
+                return;
+            }
+            char Header[HEADER_SIZE] = {0};
+            memcpy(Header, Magic(), 8);
+            uint64_t Sorted = Records.size();
+            memcpy(Header + 8, &Sorted, sizeof(Sorted));
+            size_t Bytes = Records.size() * sizeof(CacheRecord);
+            bool Written = write(TempFd, Header, HEADER_SIZE) == (ssize_t)HEADER_SIZE &&
+                (Bytes == 0 || write(TempFd, Records.data(), Bytes) == (ssize_t)Bytes) &&
+                fsync(TempFd) == 0;
+            close(TempFd);
+            if (!Written || rename(TempPath.c_str(), Path.c_str()) == -1){
+                unlink(TempPath.c_str());
+                return;
+            }
+            if (OpenFile()){
+                Refresh();
+            }
+        }
+
+    public:
+
+        //Results kept per position and budget. Lookups pick between them at random
+        static const size_t SAMPLES_PER_TIER = 4;
+
+        //Starts out with no file, so every lookup misses
+        ResultCache(){
+            Fd = -1;
+            LockFd = -1;
+            Inode = 0;
+            Map = nullptr;
+            MapSize = 0;
+            SortedCount = 0;
+            MaxEntries = 0;
+        }
+
+        ~ResultCache(){
+            CloseFile();
+            if (LockFd != -1){
+                close(LockFd);
+            }
+        }
+
+        /*Opens or creates the cache file at NewPath, keeping up to NewMaxEntries
+        records. Returns false if the file can't be used*/
+        bool Open(string NewPath, size_t NewMaxEntries){
+            lock_guard<mutex> Guard(CacheLock);
+            Path = NewPath;
+            MaxEntries = max((size_t)1, NewMaxEntries);
+            LockFd = open((Path + ".lock").c_str(), O_RDWR | O_CREAT, 0644);
+            if (LockFd == -1){
+                return false;
+            }
+
+            //Lock so two processes don't both write a header to a new file
+            if (flock(LockFd, LOCK_EX) == -1){
+                close(LockFd);
+                LockFd = -1;
+                return false;
+            }
+            bool Opened = OpenFile();
+            flock(LockFd, LOCK_UN);
+            if (!Opened){
+                close(LockFd);
+                LockFd = -1;
+                return false;
+            }
+            Refresh();
+            return true;
+        }
+
+        /*Looks up results saved for Pos or its mirror image by searches with the
+        given budget. Fills in one picked at random and returns how many there are*/
+        int Lookup(BitBoard Pos, uint32_t Budget, int &BestCol, double &Score){
+            lock_guard<mutex> Guard(CacheLock);
+            if (Fd == -1){
+                return 0;
+            }
+            Refresh();
+            if (Map == nullptr){
+                return 0;
+            }
+            bool Mirror = false;
+            vector<CacheRecord> Samples;
+            FindSamples(CanonicalKey(Pos, Mirror), Budget, Samples);
+            if (Samples.size() == 0){
+                return 0;
+            }
+            CacheRecord Rec = Samples.at(rand() % Samples.size());
+            BestCol = Mirror ? 6 - Rec.BestCol : Rec.BestCol;
+            Score = Rec.Score / 10000.0;
+            return Samples.size();
+        }
+
+        /*Saves a result for Pos from a search with the given budget, unless there
+        are already enough for it. Compacts the file once the unsorted tail gets
+        too long*/
+        void Store(BitBoard Pos, uint32_t Budget, int BestCol, double Score){
+            lock_guard<mutex> Guard(CacheLock);
+            if (Fd == -1 || BestCol < 0){
+                return;
+            }
+            bool Mirror = false;
+            CacheRecord Rec;
+            memset(&Rec, 0, sizeof(CacheRecord));
+            Rec.Key = CanonicalKey(Pos, Mirror);
+            Rec.Budget = Budget;
+            Rec.Score = (uint16_t)(min(1.0, max(0.0, Score)) * 10000);
+            Rec.BestCol = Mirror ? 6 - BestCol : BestCol;
+            Rec.Check = Checksum(Rec);
+
+            //Writing without the lock could interleave with another process, so skip saving instead
+            if (flock(LockFd, LOCK_EX) == -1){
+                return;
+            }
+            Refresh();
+            vector<CacheRecord> Existing;
+            if (Map != nullptr){
+                FindSamples(Rec.Key, Rec.Budget, Existing);
+            }
+            if (Fd != -1 && Existing.size() < SAMPLES_PER_TIER){
+                //Drop anything a crashed writer left half written so records stay lined up
+                struct stat FileStat;
+                if (fstat(Fd, &FileStat) == 0 && (FileStat.st_size - HEADER_SIZE) % sizeof(CacheRecord) != 0){
+                    if (ftruncate(Fd, FileStat.st_size - (FileStat.st_size - HEADER_SIZE) % sizeof(CacheRecord)) == 0){
+                        OpenFile();
+                    }
+                }
+                if (Fd != -1 && write(Fd, &Rec, sizeof(CacheRecord)) == (ssize_t)sizeof(CacheRecord)){
+                    Refresh();
+                    //Copied first since min takes references, which would need TAIL_LIMIT defined outside the class
+                    size_t TailLimit = TAIL_LIMIT;
+                    if (MappedRecords() - min(SortedCount, MappedRecords()) > min(TailLimit, MaxEntries)){
+                        Compact();
+                    }
+                }
+            }
+            flock(LockFd, LOCK_UN);
+        }
+};
+
+#else
+
+//Windows has no mmap or flock, so there the cache can't be opened and every lookup misses
+class ResultCache{
+    public:
+
+        //Results kept per position and budget. Lookups pick between them at random
+        static const size_t SAMPLES_PER_TIER = 4;
+
+        //Always fails, so the game plays without a cache
+        bool Open(string NewPath, size_t NewMaxEntries){
+            return false;
+        }
+
+        //Never finds anything
+        int Lookup(BitBoard Pos, uint32_t Budget, int &BestCol, double &Score){
+            return 0;
+        }
+
+        //Throws the result away
+        void Store(BitBoard Pos, uint32_t Budget, int BestCol, double Score){
+        }
+};
+
+#endif
+
+//A position in a Monte Carlo search tree
+struct Node {
+    BitBoard Pos; //The board after Col was played
+    int Col; //Column played to get here from the parent, or -1 for a fresh root
+    int Visits; //Number of simulations that went through here
+    double Score; //Total reward for the player who played Col. Wins are 1, draws 0.5
+    int Result; //NODE_OPEN, or NODE_WON/NODE_DRAW if the game ended here
+    int NumUntried; //Number of columns in Untried not yet expanded
+    int Untried[7]; //Columns that still need a child node
+    vector<unique_ptr<Node>> Children; //Positions that have been expanded from here
+};
+
+//Values for Node::Result
+const int NODE_OPEN = 0;
+const int NODE_WON = 1;
+const int NODE_DRAW = 2;
+
+/*Picks moves using Monte Carlo tree search (UCT). Each thread grows its own tree
+from the same root and their visit counts are added together at the end, so
+threads never have to share or lock anything. Trees are kept between moves and
+the part that's still reachable gets reused*/
+class MonteCarlo{
+    private:
+
+        //Most simulations to run per move, split across threads
+        int Playouts;
+
+        //Most time to spend per move in milliseconds
+        int TimeLimit;
+
+        //Number of threads to search with
+        int Threads;
+
+        //One tree per thread, kept around so the next search can reuse them
+        vector<unique_ptr<Node>> Trees;
+
+        //Where results are saved between runs, or nullptr if they aren't
+        ResultCache *Cache;
+
+        //Set by someone else to make a running search stop early, or nullptr if nothing can
+        atomic<bool> *StopFlag;
+
+        //Simulations run and seconds spent by all threads in the last search
+        long long LastPlayouts;
+        double LastSeconds;
+
+        //Xorshift random number generator. Much faster than rand() and safe per thread
+        static uint64_t NextRandom(uint64_t &Seed){
+            Seed ^= Seed << 13;
+            Seed ^= Seed >> 7;
+            Seed ^= Seed << 17;
+            return Seed;
+        }
+
+        //Makes a node for the given position, reached by playing Col
+        static unique_ptr<Node> MakeNode(BitBoard Pos, int Col, int Result){
+            unique_ptr<Node> NewNode(new Node);
+            NewNode -> Pos = Pos;
+            NewNode -> Col = Col;
+            NewNode -> Visits = 0;
+            NewNode -> Score = 0;
+            NewNode -> Result = Result;
+            NewNode -> NumUntried = Result == NODE_OPEN ? Pos.PlayableCols(NewNode -> Untried) : 0;
+            return NewNode;
+        }
+
+        /*Looks for Pos at or up to two moves below Root so its subtree can be reused.
+        Returns a fresh node if it can't be found*/
+        static unique_ptr<Node> Reroot(unique_ptr<Node> Root, BitBoard Pos){
+            if (Root && Root -> Pos == Pos){
+                return Root;
+            }
+            if (Root){
+                for (int i = 0; i < (int)Root -> Children.size(); i++){
+                    Node *Child = Root -> Children.at(i).get();
+                    if (Child -> Pos == Pos){
+                        return move(Root -> Children.at(i));
+                    }
+                    for (int j = 0; j < (int)Child -> Children.size(); j++){
+                        if (Child -> Children.at(j) -> Pos == Pos){
+                            return move(Child -> Children.at(j));
+                        }
+                    }
+                }
+            }
+            return MakeNode(Pos, -1, NODE_OPEN);
+        }
+
+        //Picks the child with the best UCT value
+        static Node *SelectChild(Node *Parent){
+            double LogVisits = log((double)Parent -> Visits);
+            Node *Best = nullptr;
+            double BestVal = -1;
+            for (int i = 0; i < (int)Parent -> Children.size(); i++){
+                Node *Child = Parent -> Children.at(i).get();
+                double Val = Child -> Score / Child -> Visits + 1.41 * sqrt(LogVisits / Child -> Visits);
+                if (Val > BestVal){
+                    BestVal = Val;
+                    Best = Child;
+                }
+            }
+            return Best;
+        }
+
+        //Runs one selection, expansion, simulation, and backpropagation pass
+        static void RunIteration(Node *Root, uint64_t &Seed, vector<Node *> &Path){
+            Path.clear();
+            Node *Curr = Root;
+            Path.push_back(Curr);
+
+            //Go down the tree until we find something to expand or the game ends
+            while (Curr -> Result == NODE_OPEN && Curr -> NumUntried == 0){
+                Curr = SelectChild(Curr);
+                Path.push_back(Curr);
+            }
+
+            //Add one new child in a random untried column
+            if (Curr -> Result == NODE_OPEN){
+                int Index = NextRandom(Seed) % Curr -> NumUntried;
+                int Col = Curr -> Untried[Index];
+                Curr -> Untried[Index] = Curr -> Untried[--Curr -> NumUntried];
+                BitBoard Next = Curr -> Pos;
+                int Result = Next.IsWinningMove(Col) ? NODE_WON : NODE_OPEN;
+                Next.Play(Col);
+                if (Result == NODE_OPEN && Next.IsFull()){
+                    Result = NODE_DRAW;
+                }
+                Curr -> Children.push_back(MakeNode(Next, Col, Result));
+                Curr = Curr -> Children.back().get();
+                Path.push_back(Curr);
+            }
+
+            //Reward is from the point of view of whoever moved into Curr
+            double Reward = 0.5;
+            if (Curr -> Result == NODE_WON){
+                Reward = 1;
+            } else if (Curr -> Result == NODE_OPEN){
+                Reward = 1 - (Playout(Curr -> Pos, Seed) + 1) / 2.0;
+            }
+
+            for (int i = Path.size() - 1; i >= 0; i--){
+                Path.at(i) -> Visits++;
+                Path.at(i) -> Score += Reward;
+                Reward = 1 - Reward;
+            }
+        }
+
+        /*Grows one tree until its share of the budget is spent or Stop gets set.
+        Returns simulations run*/
+        static long long SearchTree(Node *Root, long long Budget, chrono::steady_clock::time_point Deadline,
+                uint64_t Seed, atomic<bool> *Stop){
+            vector<Node *> Path;
+            long long Count = 0;
+            while (Count < Budget){
+                RunIteration(Root, Seed, Path);
+                Count++;
+
+                //Checking the clock every time would slow things down
+                if (Count % 64 == 0 && (chrono::steady_clock::now() >= Deadline || (Stop != nullptr && Stop -> load()))){
+                    break;
+                }
+            }
+            return Count;
+        }
+
+    public:
+
+        //Defaults to a small single threaded budget
+        MonteCarlo(){
+            Playouts = 1000;
+            TimeLimit = 0;
+            Threads = 1;
+            LastPlayouts = 0;
+            LastSeconds = 0;
+            Cache = nullptr;
+            StopFlag = nullptr;
+        }
+
+        //Sets a flag that stops searches early once it's true. nullptr means searches always finish
+        void SetStopFlag(atomic<bool> *Stop){
+            StopFlag = Stop;
+        }
+
+        //Sets where results get saved and looked up. nullptr turns saving off
+        void SetCache(ResultCache *NewCache){
+            Cache = NewCache;
+        }
+
+        /*Sets how much work each move gets. A time limit of 0 means only the
+        playout count matters. A thread count of 0 uses every core*/
+        void SetBudget(int NumPlayouts, int TimeMs, int NumThreads){
+            Playouts = NumPlayouts;
+            TimeLimit = TimeMs;
+            Threads = NumThreads;
+            if (Threads <= 0){
+                Threads = max(1, (int)thread::hardware_concurrency());
+            }
+            Trees.clear();
+        }
+
+        /*Plays random moves from Pos until the game ends. Returns 1 if the player
+        to move in Pos wins, -1 if they lose, and 0 for a draw*/
+        static int Playout(BitBoard Pos, uint64_t &Seed){
+            int Sign = 1;
+            int Cols[7];
+            while (!Pos.IsFull()){
+                int Num = Pos.PlayableCols(Cols);
+                int Col = Cols[NextRandom(Seed) % Num];
+                if (Pos.IsWinningMove(Col)){
+                    return Sign;
+                }
+                Pos.Play(Col);
+                Sign = -Sign;
+            }
+            return 0;
+        }
+
+        /*Searches from Pos and returns the column with the most visits, or -1 if
+        there are none. Once the cache has enough results from searches with this
+        same budget, one of them is picked at random instead of searching again*/
+        int Search(BitBoard Pos){
+            long long Budget = max(1, Playouts / Threads);
+
+            //Keyed on the configured budget, so hosts with different core counts share results
+            uint32_t TierBudget = Playouts;
+            if (Cache != nullptr){
+                int CachedCol = -1;
+                double CachedScore = 0;
+                if (Cache -> Lookup(Pos, TierBudget, CachedCol, CachedScore) >= (int)ResultCache::SAMPLES_PER_TIER &&
+                        CachedCol >= 0 && CachedCol < 7 && Pos.CanPlay(CachedCol)){
+                    LastPlayouts = 0;
+                    LastSeconds = 0;
+                    return CachedCol;
+                }
+            }
+
+            Trees.resize(Threads);
+            for (int i = 0; i < Threads; i++){
+                Trees.at(i) = Reroot(move(Trees.at(i)), Pos);
+            }
+
+            chrono::steady_clock::time_point Start = chrono::steady_clock::now();
+            chrono::steady_clock::time_point Deadline = chrono::steady_clock::time_point::max();
+            if (TimeLimit > 0){
+                Deadline = Start + chrono::milliseconds(TimeLimit);
+            }
+
+            vector<long long> Counts(Threads, 0);
+            vector<thread> Workers;
+            for (int i = 1; i < Threads; i++){
+                uint64_t Seed = ((uint64_t)rand() << 32) ^ rand() ^ (i + 1);
+                Node *Root = Trees.at(i).get();
+                long long *Count = &Counts.at(i);
+                atomic<bool> *Stop = StopFlag;
+                Workers.push_back(thread([Root, Budget, Deadline, Seed, Count, Stop](){
+                    *Count = SearchTree(Root, Budget, Deadline, Seed, Stop);
+                }));
+            }
+            Counts.at(0) = SearchTree(Trees.at(0).get(), Budget, Deadline, ((uint64_t)rand() << 32) ^ rand() ^ 1, StopFlag);
+            for (int i = 0; i < (int)Workers.size(); i++){
+                Workers.at(i).join();
+            }
+
+            LastSeconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+            LastPlayouts = 0;
+            for (int i = 0; i < Threads; i++){
+                LastPlayouts += Counts.at(i);
+            }
+
+            //Add up visits and rewards for each column across every tree
+            int Visits[7] = {0, 0, 0, 0, 0, 0, 0};
+            double Scores[7] = {0, 0, 0, 0, 0, 0, 0};
+            for (int i = 0; i < Threads; i++){
+                Node *Root = Trees.at(i).get();
+                for (int j = 0; j < (int)Root -> Children.size(); j++){
+                    Visits[Root -> Children.at(j) -> Col] += Root -> Children.at(j) -> Visits;
+                    Scores[Root -> Children.at(j) -> Col] += Root -> Children.at(j) -> Score;
+                }
+            }
+            int BestCol = -1;
+            for (int i = 0; i < 7; i++){
+                if (Pos.CanPlay(i) && (BestCol == -1 || Visits[i] > Visits[BestCol])){
+                    BestCol = i;
+                }
+            }
+            /*Only a search that ran its whole budget is saved, since one cut short by
+            the time limit or the stop flag would stand in for a full search forever*/
+            bool Finished = LastPlayouts >= Budget * Threads;
+            if (Cache != nullptr && Finished && BestCol != -1 && Visits[BestCol] > 0){
+                Cache -> Store(Pos, TierBudget, BestCol, Scores[BestCol] / Visits[BestCol]);
+            }
+            return BestCol;
+        }
+
+        //Simulations per second per core in the last search
+        double GetPlayoutRate(){
+            if (LastSeconds <= 0){
+                return 0;
+            }
+            return LastPlayouts / LastSeconds / Threads;
+        }
+};
+
 class Computer : public Player{
     private: 
 
-        //The difficulty of the AI player. Ranked 1 to 5
+        //The difficulty of the AI player. Ranked 1 to 8
         int Difficulty;
+
+        //Tree search used for difficulties above 5
+        MonteCarlo Engine;
         
         //Stores the most optimal columns a piece can be placed in
         vector<struct Space *> OptimalCols; 
@@ -512,11 +1422,39 @@ class Computer : public Player{
             IsCPU = true;
             Difficulty = Diff;
             srand(time(0));
+
+            /*Difficulties above 5 use tree search. Each tier gets a bigger playout
+            count and time limit in milliseconds, and the last uses every core*/
+            switch (Difficulty){
+                case (6):
+                    Engine.SetBudget(2000, 100, 1);
+                    break;
+                case (7):
+                    Engine.SetBudget(20000, 500, 2);
+                    break;
+                case (8):
+                    Engine.SetBudget(400000, 2000, 0);
+                    break;
+            }
+        }
+
+        //Sets where tree search results get saved between runs. nullptr turns saving off
+        void SetCache(ResultCache *Cache){
+            Engine.SetCache(Cache);
+        }
+
+        //Sets a flag that makes tree search give up early once it's true
+        void SetStopFlag(atomic<bool> *Stop){
+            Engine.SetStopFlag(Stop);
         }
 
         /*Decides which column to place a piece in. Does so using random
-        number generation weighted based on difficulty setting*/
+        number generation weighted based on difficulty setting, or tree
+        search for difficulties above 5*/
         int DecideCol(Board CurrBoard){
+            if (Difficulty > 5){
+                return Engine.Search(BitBoard(CurrBoard.BoardArray, Color));
+            }
             FindOptimalCols(CurrBoard);
             int Percentage = (rand() % (100 - 1 + 1)) + 1;
             int ColChosen = -1;
@@ -554,7 +1492,226 @@ class Computer : public Player{
         }
 };
 
-int main(){
+//The states a game can be in while it waits for something to happen
+enum GameState { AWAITING_HUMAN, AWAITING_CPU, GAME_OVER };
+
+//The kinds of events that can be sent to a game
+enum EventType { MOVE_SUBMITTED, AI_MOVE_READY, RESET };
+
+//What came of handling an event
+enum EventResult { EVENT_IGNORED, MOVE_REJECTED, MOVE_PLACED, MOVE_WON, MOVE_DRAW, GAME_RESET };
+
+//Something that happened to the game. Col is only used by MOVE_SUBMITTED
+struct GameEvent {
+    EventType Type; //What kind of event this is
+    int Col; //Column a human player chose, starting from 0
+};
+
+/*Runs a game of connect 4 as a state machine driven by events. Never touches
+cin or cout, so the same game can be played in the terminal, run headless, or
+run inside a server*/
+class Game{
+    private:
+
+        //The board being played on. Owned by whoever made the game
+        Board *PlayBoard;
+
+        //Both players, with player 1 first. Owned by whoever made the game
+        Player *Players[2];
+
+        //Whose turn it is, 1 or 2
+        int Turn;
+
+        //What the game is currently waiting on
+        GameState State;
+
+        //Tells the computer to give up on PendingMove as soon as it can
+        atomic<bool> StopMove;
+
+        //The move a computer player is working on in the background, if any
+        future<int> PendingMove;
+
+        //Win streak of the last winner, or 0 if the last game was a draw
+        int Streak;
+
+        /*Decides what to wait on based on whose turn it is. Only an actual Computer
+        can come up with its own moves, so anyone else gets moves submitted for them*/
+        void BeginTurn(){
+            bool IsComputer = Players[Turn - 1] -> GetCPU() && dynamic_cast<Computer *>(Players[Turn - 1]) != nullptr;
+            State = IsComputer ? AWAITING_CPU : AWAITING_HUMAN;
+        }
+
+        //Places a piece for the current player and moves the game along
+        EventResult PlacePiece(int Col){
+            if (Col < 0 || Col > 6){
+                return MOVE_REJECTED;
+            }
+            int Row = Players[Turn - 1] -> MakeMove(PlayBoard -> BoardArray, Col);
+            if (Row == -1){
+                return MOVE_REJECTED;
+            }
+            if (PlayBoard -> CheckWin(Row, Col)){
+                Streak = PlayBoard -> SetWinner(Turn);
+                State = GAME_OVER;
+                return MOVE_WON;
+            }
+            if (PlayBoard -> CheckFull()){
+                PlayBoard -> SetWinner(0);
+                Streak = 0;
+                State = GAME_OVER;
+                return MOVE_DRAW;
+            }
+            Turn = Turn == 1 ? 2 : 1;
+            BeginTurn();
+            return MOVE_PLACED;
+        }
+
+    public:
+
+        //Starts a new game on the given board with player 1 going first
+        Game(Board *NewBoard, Player *PlayOne, Player *PlayTwo){
+            PlayBoard = NewBoard;
+            Players[0] = PlayOne;
+            Players[1] = PlayTwo;
+            Turn = 1;
+            Streak = 0;
+            StopMove = false;
+            BeginTurn();
+        }
+
+        //Stops any move still being worked on so cleaning up doesn't wait on it
+        ~Game(){
+            StopMove = true;
+            if (PendingMove.valid()){
+                PendingMove.wait();
+            }
+        }
+
+        /*Starts the computer's move in the background if it's their turn and
+        it hasn't been started yet. Never waits. Returns true once the move is
+        ready to be sent in with an AI_MOVE_READY event*/
+        bool PollCPU(){
+            if (State != AWAITING_CPU){
+                return false;
+            }
+            if (!PendingMove.valid()){
+                Computer *CompPlayer = dynamic_cast<Computer *>(Players[Turn - 1]);
+                if (CompPlayer == nullptr){
+                    return false;
+                }
+                StopMove = false;
+                CompPlayer -> SetStopFlag(&StopMove);
+
+                //The computer gets its own copy, so the real board is free to change while it thinks
+                Board Snapshot = *PlayBoard;
+                PendingMove = async(launch::async, [CompPlayer, Snapshot](){
+                    int Col = CompPlayer -> DecideCol(Snapshot);
+
+                    //So the computer isn't left pointing at our flag once we're gone
+                    CompPlayer -> SetStopFlag(nullptr);
+                    return Col;
+                });
+            }
+            return PendingMove.wait_for(chrono::seconds(0)) == future_status::ready;
+        }
+
+        /*Handles a single event and returns what came of it. AI_MOVE_READY waits
+        on the computer's move if it isn't done yet, so call PollCPU first
+        if waiting isn't allowed. RESET tells a pending move to stop and then
+        waits for it to notice, which takes well under a millisecond*/
+        EventResult HandleEvent(GameEvent Event){
+            switch (Event.Type){
+                case (MOVE_SUBMITTED):
+                    if (State != AWAITING_HUMAN){
+                        return EVENT_IGNORED;
+                    }
+                    return PlacePiece(Event.Col);
+                case (AI_MOVE_READY):
+                    if (State != AWAITING_CPU){
+                        return EVENT_IGNORED;
+                    }
+                    PollCPU();
+                    if (!PendingMove.valid()){
+                        return EVENT_IGNORED;
+                    }
+                    return PlacePiece(PendingMove.get());
+                case (RESET):
+                    //Stop any move the computer was making for the old game and throw it away
+                    if (PendingMove.valid()){
+                        StopMove = true;
+                        PendingMove.get();
+                    }
+                    PlayBoard -> ResetGame();
+                    Turn = 1;
+                    BeginTurn();
+                    return GAME_RESET;
+            }
+            return EVENT_IGNORED;
+        }
+
+        //Returns what the game is currently waiting on
+        GameState GetState(){
+            return State;
+        }
+
+        //Returns whose turn it is, 1 or 2
+        int GetTurn(){
+            return Turn;
+        }
+
+        //Returns the last winner's win streak
+        int GetStreak(){
+            return Streak;
+        }
+
+        //Returns the current board as one string, ready to be written out
+        string Render(){
+            return PlayBoard -> RenderBoard();
+        }
+};
+
+/*Measures how fast the tree search runs and prints it. Run with --bench.
+Raw playouts are timed on one core, then a full search is timed on every core*/
+void RunBenchmark(){
+    uint64_t Seed = ((uint64_t)time(0) << 1) | 1;
+    long long Count = 0;
+    chrono::steady_clock::time_point Start = chrono::steady_clock::now();
+    chrono::steady_clock::time_point End = Start + chrono::seconds(1);
+    while (chrono::steady_clock::now() < End){
+        for (int i = 0; i < 1000; i++){
+            MonteCarlo::Playout(BitBoard(), Seed);
+        }
+        Count += 1000;
+    }
+    double Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+    cout << "Random playouts per second per core: " + to_string((long long)(Count / Seconds)) + "\n";
+
+    MonteCarlo Engine;
+    Engine.SetBudget(1000000, 1000, 0);
+    Engine.Search(BitBoard());
+    cout << "Tree search playouts per second per core: " + to_string((long long)Engine.GetPlayoutRate()) + "\n";
+}
+
+int main(int argc, char **argv){
+    /*--cache PATH saves tree search results to PATH so later runs, and other
+    processes using the same file, can skip positions that were already searched*/
+    ResultCache Cache;
+    ResultCache *UseCache = nullptr;
+    for (int i = 1; i < argc; i++){
+        string Arg = argv[i];
+        if (Arg == "--bench"){
+            RunBenchmark();
+            return 0;
+        } else if (Arg == "--cache" && i + 1 < argc){
+            i++;
+            if (Cache.Open(argv[i], 1 << 20)){
+                UseCache = &Cache;
+            } else {
+                cout << "Couldn't open the result cache at " << argv[i] << ", playing without it\n";
+            }
+        }
+    }
+
     cout << "Welcome to Connect 4!\n";
     Board *PlayBoard = new Board;
     Player *PlayOne;
@@ -592,16 +1749,18 @@ int main(){
         PlayOne = new Player(toupper(ColorChoice));
     } else if (PlayType == 'C' || PlayType == 'c'){
         while (!SetUp){
-            cout << "What difficulty setting will the computer have (1 - 5)?\n";
+            cout << "What difficulty setting will the computer have (1 - 8)?\n";
             cin >> Difficulty;
-            if (Difficulty < 1 || Difficulty > 5){
+            if (Difficulty < 1 || Difficulty > 8){
                 cout << "Sorry, that's an invalid entry, please try again\n";
                 continue;
             } else {
                 SetUp = true;
             }
         }
-        PlayOne = new Computer(toupper(ColorChoice), Difficulty);
+        Computer *CompPlayer = new Computer(toupper(ColorChoice), Difficulty);
+        CompPlayer -> SetCache(UseCache);
+        PlayOne = CompPlayer;
     }
     SetUp = false;
 
@@ -623,84 +1782,88 @@ int main(){
         PlayTwo = new Player(toupper(ColorChoice));
     } else if (PlayType == 'C' || PlayType == 'c'){
         while (!SetUp){
-            cout << "What difficulty setting will the computer have (1 - 5)?\n";
+            cout << "What difficulty setting will the computer have (1 - 8)?\n";
             cin >> Difficulty;
-            if (Difficulty < 1 || Difficulty > 5){
+            if (Difficulty < 1 || Difficulty > 8){
                 cout << "Sorry, that's an invalid entry, please try again\n";
                 continue;
             } else {
                 SetUp = true;
             }
         }
-        PlayTwo = new Computer(toupper(ColorChoice), Difficulty);
+        Computer *CompPlayer = new Computer(toupper(ColorChoice), Difficulty);
+        CompPlayer -> SetCache(UseCache);
+        PlayTwo = CompPlayer;
     }
 
+    Game CurrGame(PlayBoard, PlayOne, PlayTwo);
     bool Play = true;
-    int Turn = 1;
-    Player *CurrPlayer = PlayOne;
 
-    PlayBoard->PrintBoard();
+    //Everything we want to print is collected here and written out in one go
+    string Frame = CurrGame.Render();
     while (Play){
-        CurrPlayer = Turn == 1 ? PlayOne : PlayTwo;
-        cout << "Player " << Turn << "\'s turn!\n";
-        bool PlayCPU = CurrPlayer -> GetCPU();
-        int ColChosen = -1;
-        int Row = -1;
-        while (Row == -1){
-            if (!PlayCPU){
-                while (ColChosen < 0 || ColChosen > 6){
-                    cout << "Please select a column to place a piece (1 - 7)\n";
-                    cin >> ColChosen;
-                    ColChosen--;
-                    if (ColChosen < 0 || ColChosen > 6 || !cin.good()){
-                        cout  << "Sorry, that's an invalid entry. Please try again\n";
-                        ColChosen = -1;
-                        cin.clear();
-
-                        //Apparently this neat line helps limit us to numbers instead of chars. Avoids infinite loop
-                        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                    }
+        int Turn = CurrGame.GetTurn();
+        Frame += "Player " + to_string(Turn) + "\'s turn!\n";
+        EventResult Result = MOVE_REJECTED;
+        while (Result == MOVE_REJECTED){
+            if (CurrGame.GetState() == AWAITING_HUMAN){
+                Frame += "Please select a column to place a piece (1 - 7)\n";
+                cout << Frame;
+                Frame.clear();
+                int ColChosen = -1;
+                cin >> ColChosen;
+                ColChosen--;
+                if (ColChosen < 0 || ColChosen > 6 || !cin.good()){
+                    Frame += "Sorry, that's an invalid entry. Please try again\n";
+                    cin.clear();
+
+                    //Apparently this neat line helps limit us to numbers instead of chars. Avoids infinite loop
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    continue;
                 }
+                Result = CurrGame.HandleEvent({MOVE_SUBMITTED, ColChosen});
             } else {
-                cout << "Computer is making move\n";
-                //IS THERE A BETTER WAY TO DO THIS BESIDES CASTING?
-                Computer *CompPlayer = dynamic_cast<Computer *>(CurrPlayer);
-                ColChosen = CompPlayer -> DecideCol(*PlayBoard);
+                Frame += "Computer is making move\n";
+                cout << Frame << flush;
+                Frame.clear();
+
+                //Poll instead of waiting so the terminal isn't stuck while the computer thinks
+                while (!CurrGame.PollCPU()){
+                    this_thread::sleep_for(chrono::milliseconds(10));
+                }
+                Result = CurrGame.HandleEvent({AI_MOVE_READY, -1});
             }
-            Row = CurrPlayer -> MakeMove(PlayBoard -> BoardArray, ColChosen);
-            if (Row == -1){
-                cout << "Sorry, you can't place anything in that column\n";
+            if (Result == MOVE_REJECTED){
+                Frame += "Sorry, you can't place anything in that column\n";
             }
         }
-        PlayBoard -> PrintBoard();
-        bool IsWon = PlayBoard -> CheckWin(Row, ColChosen);
-        bool IsDraw = PlayBoard -> CheckFull();
-        if (IsWon || IsDraw){
-            if (IsWon){
-                int Streak = PlayBoard -> SetWinner(Turn);
-                cout << "Player " << Turn << " Wins!\n";
+        Frame += CurrGame.Render();
+        cout << Frame << flush;
+        Frame.clear();
+        if (Result == MOVE_WON || Result == MOVE_DRAW){
+            if (Result == MOVE_WON){
+                int Streak = CurrGame.GetStreak();
+                Frame += "Player " + to_string(Turn) + " Wins!\n";
                 if (Streak > 1){
-                    cout << "This is win number " << Streak << " for them!\n";
+                    Frame += "This is win number " + to_string(Streak) + " for them!\n";
                 }
-            } else if (IsDraw){
-                PlayBoard -> SetWinner(0);
-                cout << "It's a Draw!\n";
+            } else {
+                Frame += "It's a Draw!\n";
             }
             char Decision = ' ';
             while (toupper(Decision) !=  'Y' && toupper(Decision) != 'N'){
-                cout << "Would you like to play again (Y/N)?\n";
+                Frame += "Would you like to play again (Y/N)?\n";
+                cout << Frame;
+                Frame.clear();
                 cin >> Decision;
                 if (Decision == 'Y' || Decision == 'y'){
-                    Turn = 1;
-                    PlayBoard -> ResetGame();
+                    CurrGame.HandleEvent({RESET, -1});
                 } else if (Decision == 'N' || Decision == 'n'){
                     Play = false;
                 } else {
-                    cout  << "Sorry, that's an invalid entry. Please try again\n";
+                    Frame += "Sorry, that's an invalid entry. Please try again\n";
                 }
             }
-        } else {
-            Turn = Turn == 1 ? 2 : 1;
         }
     }
     cout << "Okay, Thanks for playing!\n";
@@ -708,9 +1871,6 @@ int main(){
     //Free up the memory we used
     delete PlayOne;
     delete PlayTwo;
-    for (int i = 0; i < 6; i++){
-        delete PlayBoard -> BoardArray[i];
-    }
     delete PlayBoard;
     return 1;
 }
\ No newline at end of file